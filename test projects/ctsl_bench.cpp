@@ -0,0 +1,2162 @@
+/******************************************************************************************************************************************
+ *
+ * C Tools Library (CTSL)
+ *
+ * Copyright (C) 2022 Roland Mishaev (rmishaev@gmail.com)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *******************************************************************************************************************************************/
+
+//CTSL benchmark suite.
+//Every case is measured for each size of the decade sweep [--min, --max] with warm-up runs, repeated
+//until both --reps samples and --min-time seconds (at most --max-reps samples) are collected. Results are printed as a table and
+//written as JSON (--json) so that runs of different CTSL releases can be compared; --label (default: the
+//CTSL_BENCH_LABEL CMake cache variable) names the run, e.g. the tested release.
+//Every case validates the status/result of the calls it times; a failing case is reported under "failures"
+//instead of being timed, and the exit code is non-zero.
+//Single-call cases (find, clone...) repeat the call until the timed region lasts 10 us and report the time of one call
+//("calls" in the JSON), so that the clock overhead ("clock_overhead_ns" in "config") does not distort small sizes.
+//p99 is only reported for cases with at least 100 samples ("p99_ns": null otherwise): with fewer it is just the maximum.
+//
+//The cases are a sample, one per algorithm, not every exported function. Left out:
+// - the _chr/_str/_stra/_strw/ex variants of a timed string operation (other argument type), numeric conversions
+//   other than itos/stoi and dtos/stod, and starts/ends_with, contains, find_first, insert_str, reverse_range and
+//   swap_range (variants of the timed compare/find/insert/reverse); CTSL has no trim function;
+// - string_w beyond from_str/find_str/reverse: it mirrors string_a, and strw_append_*, strw_from_stra (heap corruption)
+//   and strw_insert_chr (no-op) are unusable in CTSL 1.0;
+// - vector_gn insert/remove (timed on vector_st), vecg_clone (double free in CTSL 1.0), vect_replace_item/resize/revert/swap/sort_ex,
+//   map_replace_value/contains_key/object_by_key, slist insert/pop/replace and qus/qug_item;
+// - accessors without a loop (size, capacity, is_empty, front/back, clear, iterator reset).
+//
+//usage: ctsl_bench [--min 1e2] [--max 1e8] [--reps 5] [--warmup 1] [--max-reps 10000] [--min-time 0.2] [--filter text] [--label name] [--json file]
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <algorithm>
+#include <any>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <list>
+#include <map>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <ctsl.h>
+
+
+#ifndef CTSL_BENCH_LABEL
+#define CTSL_BENCH_LABEL        ""
+#endif
+
+#ifndef CTSL_BENCH_BUILD_TYPE
+#define CTSL_BENCH_BUILD_TYPE   ""
+#endif
+
+#ifndef CTSL_BENCH_COMPILER
+#define CTSL_BENCH_COMPILER     "unknown"
+#endif
+
+#if defined(__OPTIMIZE__) || (defined(_MSC_VER) && defined(NDEBUG))
+#define CTSL_BENCH_OPTIMIZED    true
+#else
+#define CTSL_BENCH_OPTIMIZED    false
+#endif
+
+#pragma region common
+
+typedef std::chrono::steady_clock bench_clock;
+
+typedef struct bench_config_s {
+    size_t min_size;
+    size_t max_size;
+    size_t reps;
+    size_t warmup;
+    size_t max_reps;        /* upper bound for the --min-time driven repetitions */
+    double min_time;        /* seconds */
+    const char* filter;
+    const char* json_path;
+    const char* label;      /* identifies the run (release, commit...) in the JSON output */
+}bench_config_t;
+
+typedef struct bench_case_s {
+    const char* group;      /* container or string type */
+    const char* op;         /* measured operation */
+    const char* impl;       /* "ctsl" or "stl" */
+    size_t max_size;        /* sizes above this limit are skipped (memory or O(n^2) bound) */
+    double (*run)(size_t n);   /* prepares the data, returns ns spent in the measured part only */
+}bench_case_t;
+
+typedef struct bench_result_s {
+    const bench_case_t* bcase;
+    size_t size;
+    size_t reps;
+    size_t calls;           /* calls timed per sample (BENCH_REPEAT), the ns figures are per call */
+    double median_ns;
+    double p99_ns;         /* NAN below P99_MIN_SAMPLES samples, where it would only be the maximum */
+    double min_ns;
+    double mean_ns;
+    double stddev_ns;
+    double ops_per_sec;     /* processed items per second, based on median */
+}bench_result_t;
+
+typedef struct bench_failure_s {
+    const bench_case_t* bcase;
+    size_t size;
+    const char* error;
+}bench_failure_t;
+
+static volatile uint64_t sink; /* keeps the measured loops from being optimized away */
+
+static const char* bench_error; /* set by a case whose measured call failed or returned a wrong result */
+
+static size_t bench_repeat = 1; /* calls per sample of the single-call cases, calibrated by run_case */
+
+static size_t bench_calls = 1; /* calls per sample of the last run: 1 or bench_repeat */
+
+static std::vector<int> keys; /* shuffled 0..n-1, shared by all cases of the same size */
+
+static void prepare_keys(size_t n)
+{
+    if (keys.size() == n)
+        return;
+
+    keys.resize(n);
+    for (size_t i = 0; i < n; ++i)
+        keys[i] = (int)i;
+
+    std::mt19937_64 rng(0x5eed);
+    std::shuffle(keys.begin(), keys.end(), rng);
+}
+
+static uint64_t keys_sum(size_t n) //sum of 0..n-1: expected total of every full pass over keys or map values
+{
+    return (uint64_t)n * (n - 1) / 2;
+}
+
+static double bench_failed(const char* what)
+{
+    bench_error = what;
+    return -1;
+}
+
+#define BENCH_BEGIN     bench_calls = 1; bench_clock::time_point bench_t0 = bench_clock::now();
+#define BENCH_END       double bench_ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(bench_clock::now() - bench_t0).count() / (double)bench_calls;
+#define BENCH_NS        bench_ns
+
+//cases timing a single call repeat it bench_repeat times (BENCH_K is the current call) so that the clock overhead is
+//negligible next to the timed region; BENCH_NS is then the time of one call. Sort cases are timed once: a repeated
+//call would sort sorted data
+#define BENCH_REPEAT_BEGIN  bench_calls = bench_repeat; bench_clock::time_point bench_t0 = bench_clock::now(); \
+                            for (size_t bench_k = 0; bench_k < bench_calls; ++bench_k) {
+#define BENCH_REPEAT_END    } BENCH_END
+#define BENCH_K             bench_k
+
+//keeps a repeated STL call from being hoisted out of the BENCH_REPEAT loop: the object may have changed between calls
+static inline void bench_escape(const void* object)
+{
+#if defined(_MSC_VER)
+    static const void* volatile escaped;
+    escaped = object;
+#else
+    asm volatile("" : : "g"(object) : "memory");
+#endif
+}
+
+//must follow the clean-up of the case: the case returns immediately on failure
+#define BENCH_CHECK(cond, what)     if (!(cond)) return bench_failed(what);
+
+#pragma endregion
+
+
+#pragma region compare
+
+static int int_compare(const void* left, const void* right){ //vector_st_t items
+    int l = *(const int*)left;
+    int r = *(const int*)right;
+    return (l > r) - (l < r);
+}
+
+static int obj_int_compare(const void* left, const void* right){ //object_t items (map keys)
+    int l = cust.getInt32(((const object_t*)left)->data);
+    int r = cust.getInt32(((const object_t*)right)->data);
+    return (l > r) - (l < r);
+}
+
+static int value_compare(const void* value, const void* item){ //map_contains_value: raw value vs stored object_t
+    return *(const size_t*)value != cust.getUint64(((const object_t*)item)->data);
+}
+
+#pragma endregion
+
+
+#pragma region vector_st
+
+static vector_st_t* vect_filled(size_t n) //returns NULL if the vector could not be filled
+{
+    vector_st_t* vec = vect_create(n, sizeof(int), NULL);
+    size_t failed = 0;
+
+    for (size_t i = 0; i < n; ++i)
+        failed += CTL_FAILED(vect_push_back(vec, &keys[i]));
+
+    if (failed || vect_size(vec) != n) {
+        vect_delete(vec);
+        return NULL;
+    }
+
+    return vec;
+}
+
+static double vect_push_back_bench(size_t n)
+{
+    vector_st_t* vec = vect_create(1, sizeof(int), NULL);
+    size_t failed = 0;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i)
+        failed += CTL_FAILED(vect_push_back(vec, &keys[i]));
+    BENCH_END
+
+    bool ok = !failed && vect_size(vec) == n;
+    vect_delete(vec);
+    BENCH_CHECK(ok, "vect_push_back");
+    return BENCH_NS;
+}
+
+static double vect_item_direct_bench(size_t n)
+{
+    vector_st_t* vec = vect_filled(n);
+    BENCH_CHECK(vec, "vect_push_back (setup)");
+    uint64_t sum = 0;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i)
+        sum += *(const int*)vect_item_direct(vec, i);
+    BENCH_END
+
+    sink = sum;
+    vect_delete(vec);
+    BENCH_CHECK(sum == keys_sum(n), "vect_item_direct: wrong items");
+    return BENCH_NS;
+}
+
+static double vect_item_bench(size_t n)
+{
+    vector_st_t* vec = vect_filled(n);
+    BENCH_CHECK(vec, "vect_push_back (setup)");
+    uint64_t sum = 0;
+    size_t failed = 0;
+    int item = 0;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i) {
+        failed += CTL_FAILED(vect_item(vec, i, &item));
+        sum += item;
+    }
+    BENCH_END
+
+    sink = sum;
+    vect_delete(vec);
+    BENCH_CHECK(!failed && sum == keys_sum(n), "vect_item");
+    return BENCH_NS;
+}
+
+static double vect_find_item_bench(size_t n)
+{
+    vector_st_t* vec = vect_filled(n);
+    BENCH_CHECK(vec, "vect_push_back (setup)");
+    int missing = -1; /* forces a full scan */
+    long index = 0;
+
+    BENCH_REPEAT_BEGIN
+    index = vect_find_item(vec, &missing, NULL);
+    BENCH_REPEAT_END
+
+    sink = (uint64_t)index;
+    vect_delete(vec);
+    BENCH_CHECK(index == -1, "vect_find_item: found a missing item");
+    return BENCH_NS;
+}
+
+static double vect_sort_bench(size_t n)
+{
+    vector_st_t* vec = vect_filled(n);
+    BENCH_CHECK(vec, "vect_push_back (setup)");
+
+    BENCH_BEGIN
+    STATUS status = vect_sort(vec, int_compare);
+    BENCH_END
+
+    bool ok = status == STATUS_OK;
+    for (size_t i = 0; ok && i < n; ++i)    /* keys are a permutation of 0..n-1 */
+        ok = *(const int*)vect_item_direct(vec, i) == (int)i;
+
+    vect_delete(vec);
+    BENCH_CHECK(ok, "vect_sort");
+    return BENCH_NS;
+}
+
+static double vect_clone_bench(size_t n)
+{
+    vector_st_t* vec = vect_filled(n);
+    BENCH_CHECK(vec, "vect_push_back (setup)");
+    std::vector<vector_st_t*> clones(bench_repeat);
+
+    BENCH_REPEAT_BEGIN
+    clones[BENCH_K] = vect_clone(vec, NULL);
+    BENCH_REPEAT_END
+
+    bool ok = true;
+    for (vector_st_t* clone : clones) {
+        ok = ok && clone && vect_size(clone) == n;
+        if (clone)
+            vect_delete(clone);
+    }
+    vect_delete(vec);
+    BENCH_CHECK(ok, "vect_clone");
+    return BENCH_NS;
+}
+
+static double vect_remove_front_bench(size_t n)
+{
+    vector_st_t* vec = vect_filled(n);
+    BENCH_CHECK(vec, "vect_push_back (setup)");
+    size_t failed = 0;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i)
+        failed += CTL_FAILED(vect_remove_item(vec, 0));
+    BENCH_END
+
+    bool ok = !failed && vect_size(vec) == 0;
+    vect_delete(vec);
+    BENCH_CHECK(ok, "vect_remove_item");
+    return BENCH_NS;
+}
+
+static double vect_insert_middle_bench(size_t n)
+{
+    vector_st_t* vec = vect_create(n + 1, sizeof(int), NULL);
+    int first = -1;
+    BENCH_CHECK(!CTL_FAILED(vect_push_back(vec, &first)), "vect_push_back (setup)");  /* vect_insert_item needs index < size */
+    size_t failed = 0;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i)
+        failed += CTL_FAILED(vect_insert_item(vec, vect_size(vec) / 2, &keys[i]));
+    BENCH_END
+
+    bool ok = !failed && vect_size(vec) == n + 1;
+    vect_delete(vec);
+    BENCH_CHECK(ok, "vect_insert_item");
+    return BENCH_NS;
+}
+
+static double vect_remove_range_bench(size_t n)
+{
+    vector_st_t* vec = vect_filled(n);
+    BENCH_CHECK(vec, "vect_push_back (setup)");
+    size_t failed = 0;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n / 10; ++i)     /* 10 items from the middle per call */
+        failed += CTL_FAILED(vect_remove_range(vec, (vect_size(vec) - 10) / 2, 10));
+    BENCH_END
+
+    bool ok = !failed && vect_size(vec) == n % 10;
+    vect_delete(vec);
+    BENCH_CHECK(ok, "vect_remove_range");
+    return BENCH_NS;
+}
+
+static double stl_vector_push_back_bench(size_t n)
+{
+    std::vector<int> vec;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i)
+        vec.push_back(keys[i]);
+    BENCH_END
+
+    sink = vec.size();
+    BENCH_CHECK(vec.size() == n, "std::vector::push_back");
+    return BENCH_NS;
+}
+
+static double stl_vector_index_bench(size_t n)
+{
+    std::vector<int> vec(keys.begin(), keys.begin() + n);
+    uint64_t sum = 0;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i)
+        sum += vec[i];
+    BENCH_END
+
+    sink = sum;
+    BENCH_CHECK(sum == keys_sum(n), "std::vector::operator[]: wrong items");
+    return BENCH_NS;
+}
+
+static double stl_vector_find_bench(size_t n)
+{
+    std::vector<int> vec(keys.begin(), keys.begin() + n);
+    bool found = false;
+
+    BENCH_REPEAT_BEGIN
+    bench_escape(&vec);
+    found = std::find(vec.begin(), vec.end(), -1) != vec.end();
+    BENCH_REPEAT_END
+
+    sink = found;
+    BENCH_CHECK(!found, "std::find: found a missing item");
+    return BENCH_NS;
+}
+
+static double stl_vector_sort_bench(size_t n)
+{
+    std::vector<int> vec(keys.begin(), keys.begin() + n);
+
+    BENCH_BEGIN
+    std::sort(vec.begin(), vec.end());
+    BENCH_END
+
+    sink = (uint64_t)vec[0];
+    BENCH_CHECK(vec[0] == 0 && vec[n - 1] == (int)(n - 1), "std::sort");
+    return BENCH_NS;
+}
+
+static double stl_vector_copy_bench(size_t n)
+{
+    std::vector<int> vec(keys.begin(), keys.begin() + n);
+    std::vector<std::vector<int>> clones(bench_repeat);
+
+    BENCH_REPEAT_BEGIN
+    clones[BENCH_K] = vec;
+    BENCH_REPEAT_END
+
+    bool ok = true;
+    for (const std::vector<int>& clone : clones)
+        ok = ok && clone.size() == n;
+
+    sink = clones.size();
+    BENCH_CHECK(ok, "std::vector copy");
+    return BENCH_NS;
+}
+
+static double stl_vector_erase_front_bench(size_t n)
+{
+    std::vector<int> vec(keys.begin(), keys.begin() + n);
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i)
+        vec.erase(vec.begin());
+    BENCH_END
+
+    sink = vec.size();
+    BENCH_CHECK(vec.empty(), "std::vector::erase");
+    return BENCH_NS;
+}
+
+static double stl_vector_insert_middle_bench(size_t n)
+{
+    std::vector<int> vec(1, -1);
+    vec.reserve(n + 1);
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i)
+        vec.insert(vec.begin() + vec.size() / 2, keys[i]);
+    BENCH_END
+
+    sink = vec.size();
+    BENCH_CHECK(vec.size() == n + 1, "std::vector::insert");
+    return BENCH_NS;
+}
+
+static double stl_vector_erase_range_bench(size_t n)
+{
+    std::vector<int> vec(keys.begin(), keys.begin() + n);
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n / 10; ++i) {
+        std::vector<int>::iterator first = vec.begin() + (vec.size() - 10) / 2;
+        vec.erase(first, first + 10);
+    }
+    BENCH_END
+
+    sink = vec.size();
+    BENCH_CHECK(vec.size() == n % 10, "std::vector::erase(range)");
+    return BENCH_NS;
+}
+
+#pragma endregion
+
+
+#pragma region vector_gn
+
+static vector_gn_t* vecg_filled(size_t n) //returns NULL if the vector could not be filled
+{
+    vector_gn_t* vec = vecg_create(n, NULL);
+    size_t failed = 0;
+
+    for (size_t i = 0; i < n; ++i)
+        failed += CTL_FAILED(vecg_push_back(vec, &keys[i], sizeof(int), otInt32));
+
+    if (failed || vecg_size(vec) != n) {
+        vecg_delete(vec);
+        return NULL;
+    }
+
+    return vec;
+}
+
+static double vecg_push_back_bench(size_t n)
+{
+    vector_gn_t* vec = vecg_create(1, NULL);
+    size_t failed = 0;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i)
+        failed += CTL_FAILED(vecg_push_back(vec, &keys[i], sizeof(int), otInt32));
+    BENCH_END
+
+    bool ok = !failed && vecg_size(vec) == n;
+    vecg_delete(vec);
+    BENCH_CHECK(ok, "vecg_push_back");
+    return BENCH_NS;
+}
+
+static double vecg_item_bench(size_t n)
+{
+    vector_gn_t* vec = vecg_filled(n);
+    BENCH_CHECK(vec, "vecg_push_back (setup)");
+    uint64_t sum = 0;
+    size_t failed = 0;
+    object_t item;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i) {
+        if (CTL_FAILED(vecg_item(vec, i, &item)))
+            ++failed;
+        else
+            sum += cust.getInt32(item.data);
+    }
+    BENCH_END
+
+    sink = sum;
+    vecg_delete(vec);
+    BENCH_CHECK(!failed && sum == keys_sum(n), "vecg_item");
+    return BENCH_NS;
+}
+
+static double vecg_find_item_bench(size_t n)
+{
+    vector_gn_t* vec = vecg_filled(n);
+    BENCH_CHECK(vec, "vecg_push_back (setup)");
+    int missing = -1;
+    long index = 0;
+
+    BENCH_REPEAT_BEGIN
+    index = vecg_find_item(vec, &missing, sizeof(int), otInt32, NULL);
+    BENCH_REPEAT_END
+
+    sink = (uint64_t)index;
+    vecg_delete(vec);
+    BENCH_CHECK(index == -1, "vecg_find_item: found a missing item");
+    return BENCH_NS;
+}
+
+static double vecg_sort_bench(size_t n)
+{
+    vector_gn_t* vec = vecg_filled(n);
+    BENCH_CHECK(vec, "vecg_push_back (setup)");
+
+    BENCH_BEGIN
+    STATUS status = vecg_sort(vec, NULL);  //default compare: custom compare callbacks are not stable in vecg_sort of CTSL 1.0
+    BENCH_END
+
+    /* the default compare orders items by their bytes */
+    bool ok = status == STATUS_OK && vecg_size(vec) == n;
+    object_t prev, item;
+    for (size_t i = 1; ok && i < n; ++i) {
+        ok = SUCCEEDED(vecg_item(vec, i - 1, &prev)) && SUCCEEDED(vecg_item(vec, i, &item))
+             && memcmp(prev.data, item.data, sizeof(int)) <= 0;
+    }
+
+    vecg_delete(vec);
+    BENCH_CHECK(ok, "vecg_sort");
+    return BENCH_NS;
+}
+
+//STL baselines: std::any is the STL counterpart of a vector_gn_t/queue_gn_t item (any type per item)
+static std::vector<std::any> stl_any_filled(size_t n)
+{
+    std::vector<std::any> vec;
+    vec.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+        vec.emplace_back(keys[i]);
+    return vec;
+}
+
+static double stl_any_push_back_bench(size_t n)
+{
+    std::vector<std::any> vec;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i)
+        vec.emplace_back(keys[i]);
+    BENCH_END
+
+    sink = vec.size();
+    BENCH_CHECK(vec.size() == n, "std::vector<std::any>::emplace_back");
+    return BENCH_NS;
+}
+
+static double stl_any_item_bench(size_t n)
+{
+    std::vector<std::any> vec = stl_any_filled(n);
+    uint64_t sum = 0;
+    size_t failed = 0;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i) {
+        const int* item = std::any_cast<int>(&vec[i]);
+        if (item)
+            sum += *item;
+        else
+            ++failed;
+    }
+    BENCH_END
+
+    sink = sum;
+    BENCH_CHECK(!failed && sum == keys_sum(n), "std::any_cast");
+    return BENCH_NS;
+}
+
+static double stl_any_find_bench(size_t n)
+{
+    std::vector<std::any> vec = stl_any_filled(n);
+    int missing = -1;
+    bool found = false;
+
+    BENCH_REPEAT_BEGIN
+    bench_escape(&vec);
+    found = std::find_if(vec.begin(), vec.end(), [missing](const std::any& a) {
+        const int* item = std::any_cast<int>(&a);
+        return item && *item == missing;
+    }) != vec.end();
+    BENCH_REPEAT_END
+
+    sink = found;
+    BENCH_CHECK(!found, "std::find_if: found a missing item");
+    return BENCH_NS;
+}
+
+static double stl_any_sort_bench(size_t n)
+{
+    std::vector<std::any> vec = stl_any_filled(n);
+
+    BENCH_BEGIN
+    std::sort(vec.begin(), vec.end(), [](const std::any& a, const std::any& b) {
+        return std::any_cast<int>(a) < std::any_cast<int>(b);
+    });
+    BENCH_END
+
+    bool ok = true;
+    for (size_t i = 0; ok && i < n; ++i)
+        ok = std::any_cast<int>(vec[i]) == (int)i;
+
+    BENCH_CHECK(ok, "std::sort of std::any");
+    return BENCH_NS;
+}
+
+#pragma endregion
+
+
+#pragma region map
+
+static map_t* map_filled(size_t n) //returns NULL if the map could not be filled
+{
+    map_t* map = map_create(obj_int_compare, NULL, NULL);
+    size_t failed = 0;
+
+    for (size_t i = 0; i < n; ++i)
+        failed += CTL_FAILED(map_insert(map, &keys[i], sizeof(int), otInt32, &i, sizeof(size_t), otUInt64));
+
+    if (failed || map_size(map) != n) {
+        map_delete(map);
+        return NULL;
+    }
+
+    return map;
+}
+
+static double map_insert_bench(size_t n)
+{
+    map_t* map = map_create(obj_int_compare, NULL, NULL);
+    size_t failed = 0;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i)
+        failed += CTL_FAILED(map_insert(map, &keys[i], sizeof(int), otInt32, &i, sizeof(size_t), otUInt64));
+    BENCH_END
+
+    bool ok = !failed && map_size(map) == n;
+    map_delete(map);
+    BENCH_CHECK(ok, "map_insert");
+    return BENCH_NS;
+}
+
+static double map_value_by_key_bench(size_t n)
+{
+    map_t* map = map_filled(n);
+    BENCH_CHECK(map, "map_insert (setup)");
+    uint64_t sum = 0;
+    size_t failed = 0;
+    size_t value = 0;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i) {
+        failed += CTL_FAILED(map_value_by_key(map, &keys[n - 1 - i], sizeof(int), otInt32, &value));
+        sum += value;
+    }
+    BENCH_END
+
+    sink = sum;
+    map_delete(map);
+    BENCH_CHECK(!failed && sum == keys_sum(n), "map_value_by_key");
+    return BENCH_NS;
+}
+
+static double map_contains_value_bench(size_t n)
+{
+    map_t* map = map_filled(n);
+    BENCH_CHECK(map, "map_insert (setup)");
+    size_t missing = (size_t)-1;
+    size_t present = n - 1;
+    bool found = false;
+
+    BENCH_REPEAT_BEGIN
+    found = map_contains_value(map, &missing, value_compare);
+    BENCH_REPEAT_END
+
+    sink = found;
+    bool ok = !found && map_contains_value(map, &present, value_compare);  /* the compare must also match */
+    map_delete(map);
+    BENCH_CHECK(ok, "map_contains_value");
+    return BENCH_NS;
+}
+
+static double map_iterate_bench(size_t n)
+{
+    map_t* map = map_filled(n);
+    BENCH_CHECK(map, "map_insert (setup)");
+    iterator_t* iterator = map_create_iterator(map);
+    uint64_t sum = 0;
+    size_t count = 0;
+
+    BENCH_BEGIN
+    while (iterator->next(iterator)) {
+        sum += cust.getUint64(iterator->value->data);
+        ++count;
+    }
+    BENCH_END
+
+    sink = sum;
+    map_delete_iterator(iterator);
+    map_delete(map);
+    BENCH_CHECK(count == n && sum == keys_sum(n), "map iterator");
+    return BENCH_NS;
+}
+
+static double map_key_remove_bench(size_t n)
+{
+    map_t* map = map_filled(n);
+    BENCH_CHECK(map, "map_insert (setup)");
+    size_t failed = 0;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i)
+        failed += CTL_FAILED(map_key_remove(map, &keys[i], sizeof(int), otInt32));
+    BENCH_END
+
+    bool ok = !failed && map_size(map) == 0;
+    map_delete(map);
+    BENCH_CHECK(ok, "map_key_remove");
+    return BENCH_NS;
+}
+
+static double stl_map_insert_bench(size_t n)
+{
+    std::map<int, size_t> map;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i)
+        map.emplace(keys[i], i);
+    BENCH_END
+
+    sink = map.size();
+    BENCH_CHECK(map.size() == n, "std::map::emplace");
+    return BENCH_NS;
+}
+
+static void stl_map_fill(std::map<int, size_t>& map, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+        map.emplace(keys[i], i);
+}
+
+static double stl_map_find_bench(size_t n)
+{
+    std::map<int, size_t> map;
+    stl_map_fill(map, n);
+    uint64_t sum = 0;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i)
+        sum += map.find(keys[n - 1 - i])->second;
+    BENCH_END
+
+    sink = sum;
+    BENCH_CHECK(sum == keys_sum(n), "std::map::find");
+    return BENCH_NS;
+}
+
+static double stl_map_find_value_bench(size_t n)
+{
+    std::map<int, size_t> map;
+    stl_map_fill(map, n);
+    size_t missing = (size_t)-1;
+    bool found = false;
+
+    BENCH_REPEAT_BEGIN
+    bench_escape(&map);
+    found = std::find_if(map.begin(), map.end(), [missing](const std::pair<const int, size_t>& p) { return p.second == missing; }) != map.end();
+    BENCH_REPEAT_END
+
+    sink = found;
+    BENCH_CHECK(!found, "std::find_if: found a missing value");
+    return BENCH_NS;
+}
+
+static double stl_map_iterate_bench(size_t n)
+{
+    std::map<int, size_t> map;
+    stl_map_fill(map, n);
+    uint64_t sum = 0;
+
+    BENCH_BEGIN
+    for (const auto& p : map)
+        sum += p.second;
+    BENCH_END
+
+    sink = sum;
+    BENCH_CHECK(sum == keys_sum(n), "std::map iteration");
+    return BENCH_NS;
+}
+
+static double stl_map_erase_bench(size_t n)
+{
+    std::map<int, size_t> map;
+    stl_map_fill(map, n);
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i)
+        map.erase(keys[i]);
+    BENCH_END
+
+    sink = map.size();
+    BENCH_CHECK(map.empty(), "std::map::erase");
+    return BENCH_NS;
+}
+
+#pragma endregion
+
+
+#pragma region slist
+
+static slist_t* slist_filled(size_t n) //returns NULL if the list could not be filled
+{
+    slist_t* list = slist_create(NULL, NULL);
+    size_t failed = 0;
+
+    for (size_t i = 0; i < n; ++i)
+        failed += CTL_FAILED(slist_push_back(list, &keys[i], sizeof(int), otInt32));
+
+    if (failed || slist_size(list) != n) {
+        slist_delete(list);
+        return NULL;
+    }
+
+    return list;
+}
+
+static double slist_push_back_bench(size_t n)
+{
+    slist_t* list = slist_create(NULL, NULL);
+    size_t failed = 0;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i)
+        failed += CTL_FAILED(slist_push_back(list, &keys[i], sizeof(int), otInt32));
+    BENCH_END
+
+    bool ok = !failed && slist_size(list) == n;
+    slist_delete(list);
+    BENCH_CHECK(ok, "slist_push_back");
+    return BENCH_NS;
+}
+
+static double slist_push_head_bench(size_t n)
+{
+    slist_t* list = slist_create(NULL, NULL);
+    size_t failed = 0;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i)
+        failed += CTL_FAILED(slist_push_head(list, &keys[i], sizeof(int), otInt32));
+    BENCH_END
+
+    bool ok = !failed && slist_size(list) == n;
+    slist_delete(list);
+    BENCH_CHECK(ok, "slist_push_head");
+    return BENCH_NS;
+}
+
+static double slist_contains_item_bench(size_t n)
+{
+    slist_t* list = slist_filled(n);
+    BENCH_CHECK(list, "slist_push_back (setup)");
+    int missing = -1;
+    STATUS status = STATUS_OK;
+
+    BENCH_REPEAT_BEGIN
+    status = slist_contains_item(list, &missing, sizeof(int), otInt32, NULL);
+    BENCH_REPEAT_END
+
+    sink = (uint64_t)status;
+    slist_delete(list);
+    BENCH_CHECK(status == CTL_SLIST_ITEM_NOT_FOUND, "slist_contains_item");
+    return BENCH_NS;
+}
+
+static double slist_remove_head_bench(size_t n)
+{
+    slist_t* list = slist_filled(n);
+    BENCH_CHECK(list, "slist_push_back (setup)");
+    size_t failed = 0;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i)
+        failed += CTL_FAILED(slist_remove_item_by_index(list, 0));
+    BENCH_END
+
+    bool ok = !failed && slist_size(list) == 0;
+    slist_delete(list);
+    BENCH_CHECK(ok, "slist_remove_item_by_index");
+    return BENCH_NS;
+}
+
+static double slist_remove_item_bench(size_t n)
+{
+    slist_t* list = slist_filled(n);
+    BENCH_CHECK(list, "slist_push_back (setup)");
+    size_t failed = 0;
+
+    BENCH_BEGIN
+    for (int i = 0; i < (int)n; ++i)    /* values in ascending order sit at random positions */
+        failed += CTL_FAILED(slist_remove_item(list, &i));
+    BENCH_END
+
+    bool ok = !failed && slist_size(list) == 0;
+    slist_delete(list);
+    BENCH_CHECK(ok, "slist_remove_item");
+    return BENCH_NS;
+}
+
+static double stl_list_push_back_bench(size_t n)
+{
+    std::list<int> list;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i)
+        list.push_back(keys[i]);
+    BENCH_END
+
+    sink = list.size();
+    BENCH_CHECK(list.size() == n, "std::list::push_back");
+    return BENCH_NS;
+}
+
+static double stl_list_push_front_bench(size_t n)
+{
+    std::list<int> list;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i)
+        list.push_front(keys[i]);
+    BENCH_END
+
+    sink = list.size();
+    BENCH_CHECK(list.size() == n, "std::list::push_front");
+    return BENCH_NS;
+}
+
+static double stl_list_find_bench(size_t n)
+{
+    std::list<int> list(keys.begin(), keys.begin() + n);
+    bool found = false;
+
+    BENCH_REPEAT_BEGIN
+    bench_escape(&list);
+    found = std::find(list.begin(), list.end(), -1) != list.end();
+    BENCH_REPEAT_END
+
+    sink = found;
+    BENCH_CHECK(!found, "std::find: found a missing item");
+    return BENCH_NS;
+}
+
+static double stl_list_pop_front_bench(size_t n)
+{
+    std::list<int> list(keys.begin(), keys.begin() + n);
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i)
+        list.pop_front();
+    BENCH_END
+
+    sink = list.size();
+    BENCH_CHECK(list.empty(), "std::list::pop_front");
+    return BENCH_NS;
+}
+
+static double stl_list_remove_bench(size_t n)
+{
+    std::list<int> list(keys.begin(), keys.begin() + n);
+    size_t failed = 0;
+
+    BENCH_BEGIN
+    for (int i = 0; i < (int)n; ++i) {  /* first match only, as slist_remove_item */
+        std::list<int>::iterator it = std::find(list.begin(), list.end(), i);
+        if (it == list.end())
+            ++failed;
+        else
+            list.erase(it);
+    }
+    BENCH_END
+
+    sink = list.size();
+    BENCH_CHECK(!failed && list.empty(), "std::list::erase");
+    return BENCH_NS;
+}
+
+#pragma endregion
+
+
+#pragma region queue
+
+static double qus_push_bench(size_t n)
+{
+    queue_st_t* queue = qus_create(16, sizeof(int), true);
+    size_t failed = 0;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i)
+        failed += CTL_FAILED(qus_push(queue, &keys[i]));
+    BENCH_END
+
+    bool ok = !failed && qus_size(queue) == n;
+    qus_delete(&queue);
+    BENCH_CHECK(ok, "qus_push");
+    return BENCH_NS;
+}
+
+static double qus_pop_bench(size_t n)
+{
+    queue_st_t* queue = qus_create(n, sizeof(int), false);
+    size_t failed = 0;
+    for (size_t i = 0; i < n; ++i)
+        failed += CTL_FAILED(qus_push(queue, &keys[i]));
+    if (failed || qus_size(queue) != n) {
+        qus_delete(&queue);
+        return bench_failed("qus_push (setup)");
+    }
+    uint64_t sum = 0;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i) {
+        const void* item = qus_pop(queue);
+        if (item)
+            sum += cust.getInt32(item);
+        else
+            ++failed;
+    }
+    BENCH_END
+
+    sink = sum;
+    bool ok = !failed && sum == keys_sum(n) && qus_is_empty(queue);
+    qus_delete(&queue);
+    BENCH_CHECK(ok, "qus_pop");
+    return BENCH_NS;
+}
+
+static double qug_push_bench(size_t n)
+{
+    queue_gn_t* queue = qug_create(16, true);
+    size_t failed = 0;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i)
+        failed += CTL_FAILED(qug_push(queue, &keys[i], sizeof(int), otInt32));
+    BENCH_END
+
+    bool ok = !failed && qug_size(queue) == n;
+    qug_delete(&queue);
+    BENCH_CHECK(ok, "qug_push");
+    return BENCH_NS;
+}
+
+static double qug_pop_bench(size_t n)
+{
+    queue_gn_t* queue = qug_create(n, false);
+    size_t failed = 0;
+    for (size_t i = 0; i < n; ++i)
+        failed += CTL_FAILED(qug_push(queue, &keys[i], sizeof(int), otInt32));
+    if (failed || qug_size(queue) != n) {
+        qug_delete(&queue);
+        return bench_failed("qug_push (setup)");
+    }
+    uint64_t sum = 0;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i) {
+        const object_t* item = qug_pop(queue);
+        if (item)
+            sum += cust.getInt32(item->data);
+        else
+            ++failed;
+    }
+    BENCH_END
+
+    sink = sum;
+    bool ok = !failed && sum == keys_sum(n) && qug_is_empty(queue);
+    qug_delete(&queue);
+    BENCH_CHECK(ok, "qug_pop");
+    return BENCH_NS;
+}
+
+static double stl_queue_push_bench(size_t n)
+{
+    std::queue<int> queue;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i)
+        queue.push(keys[i]);
+    BENCH_END
+
+    sink = queue.size();
+    BENCH_CHECK(queue.size() == n, "std::queue::push");
+    return BENCH_NS;
+}
+
+static double stl_queue_pop_bench(size_t n)
+{
+    std::queue<int> queue;
+    for (size_t i = 0; i < n; ++i)
+        queue.push(keys[i]);
+    uint64_t sum = 0;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i) {
+        sum += queue.front();
+        queue.pop();
+    }
+    BENCH_END
+
+    sink = sum;
+    BENCH_CHECK(queue.empty() && sum == keys_sum(n), "std::queue::pop");
+    return BENCH_NS;
+}
+
+static double stl_any_queue_push_bench(size_t n)
+{
+    std::queue<std::any> queue;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i)
+        queue.emplace(keys[i]);
+    BENCH_END
+
+    sink = queue.size();
+    BENCH_CHECK(queue.size() == n, "std::queue<std::any>::emplace");
+    return BENCH_NS;
+}
+
+static double stl_any_queue_pop_bench(size_t n)
+{
+    std::queue<std::any> queue;
+    for (size_t i = 0; i < n; ++i)
+        queue.emplace(keys[i]);
+    uint64_t sum = 0;
+    size_t failed = 0;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i) {
+        const int* item = std::any_cast<int>(&queue.front());
+        if (item)
+            sum += *item;
+        else
+            ++failed;
+        queue.pop();
+    }
+    BENCH_END
+
+    sink = sum;
+    BENCH_CHECK(!failed && queue.empty() && sum == keys_sum(n), "std::queue<std::any>::pop");
+    return BENCH_NS;
+}
+
+#pragma endregion
+
+
+#pragma region string
+
+static const char* const word = "word, ";
+
+static double stra_append_chr_bench(size_t n)
+{
+    string_a* str = stra_create();
+    size_t failed = 0;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i)
+        failed += CTL_FAILED(stra_append_chr(str, 'a'));
+    BENCH_END
+
+    bool ok = !failed && stra_length(str) == n;
+    stra_delete(&str);
+    BENCH_CHECK(ok, "stra_append_chr");
+    return BENCH_NS;
+}
+
+static double stra_append_str_bench(size_t n)
+{
+    string_a* str = stra_create();
+    size_t failed = 0;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i)
+        failed += CTL_FAILED(stra_append_str(str, word));
+    BENCH_END
+
+    bool ok = !failed && stra_length(str) == n * strlen(word);
+    stra_delete(&str);
+    BENCH_CHECK(ok, "stra_append_str");
+    return BENCH_NS;
+}
+
+static double stra_find_chr_bench(size_t n)
+{
+    std::string src(n, 'a');
+    src[n - 1] = 'b'; /* hit at the end: full scan (stra_find_chr of CTSL 1.0 faults on a miss) */
+    string_a* str = stra_from_str(src.c_str());
+
+    size_t pos = 0;
+
+    BENCH_REPEAT_BEGIN
+    pos = stra_find_chr(str, 'b', 0);
+    BENCH_REPEAT_END
+
+    sink = pos;
+    stra_delete(&str);
+    BENCH_CHECK(pos == n - 1, "stra_find_chr");
+    return BENCH_NS;
+}
+
+static double stra_find_str_bench(size_t n)
+{
+    std::string src(n, 'a');
+    src[n - 1] = 'b'; /* hit at the end: full scan */
+    string_a* str = stra_from_str(src.c_str());
+
+    size_t pos = 0;
+
+    BENCH_REPEAT_BEGIN
+    pos = stra_find_str(str, "aab", 0);
+    BENCH_REPEAT_END
+
+    sink = pos;
+    stra_delete(&str);
+    BENCH_CHECK(pos == n - 3, "stra_find_str");
+    return BENCH_NS;
+}
+
+static double stra_insert_front_bench(size_t n)
+{
+    string_a* str = stra_from_chr('a'); /* stra_insert_chr at pos 0 fails on an empty string */
+    size_t failed = 0;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i)
+        failed += CTL_FAILED(stra_insert_chr(str, 'a', 0));
+    BENCH_END
+
+    bool ok = !failed && stra_length(str) == n + 1;
+    stra_delete(&str);
+    BENCH_CHECK(ok, "stra_insert_chr");
+    return BENCH_NS;
+}
+
+static double stra_itos_stoi_bench(size_t n)
+{
+    uint64_t sum = 0;
+    size_t failed = 0;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i) {
+        string_a* str = stra_itos(keys[i]);
+        if (!str) {
+            ++failed;
+            continue;
+        }
+        sum += stra_stoi(str);
+        stra_delete(&str);
+    }
+    BENCH_END
+
+    sink = sum;
+    BENCH_CHECK(!failed && sum == keys_sum(n), "stra_itos/stra_stoi");
+    return BENCH_NS;
+}
+
+static double stra_dtos_stod_bench(size_t n)
+{
+    double sum = 0;
+    size_t failed = 0;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i) {
+        string_a* str = stra_dtos(keys[i] * 0.25);
+        if (!str) {
+            ++failed;
+            continue;
+        }
+        sum += stra_stod(str);
+        stra_delete(&str);
+    }
+    BENCH_END
+
+    sink = (uint64_t)sum;
+    BENCH_CHECK(!failed && sum == (double)keys_sum(n) * 0.25, "stra_dtos/stra_stod");
+    return BENCH_NS;
+}
+
+static double stra_splitter_bench(size_t n)
+{
+    std::string src;
+    for (size_t i = 0; i < n; ++i)
+        src.append(word);
+    string_a* str = stra_from_str(src.c_str());
+    std::vector<vector_st_t*> splitters(bench_repeat);
+
+    BENCH_REPEAT_BEGIN
+    splitters[BENCH_K] = stra_create_splitter_chr(str, ',');
+    BENCH_REPEAT_END
+
+    bool ok = true;
+    for (vector_st_t* splitter : splitters) {
+        ok = ok && splitter && vect_size(splitter) == n + 1;   /* n words plus the trailing " " */
+        if (splitter)
+            stra_delete_splitter(splitter);
+    }
+    stra_delete(&str);
+    BENCH_CHECK(ok, "stra_create_splitter_chr");
+    return BENCH_NS;
+}
+
+static double stra_replace_str_bench(size_t n)
+{
+    std::string src(n, 'a');
+    string_a* str = stra_from_str(src.c_str());
+    size_t failed = 0;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i)
+        failed += CTL_FAILED(stra_replace_str(str, i, 1, "b"));
+    BENCH_END
+
+    bool ok = !failed && std::string(stra_c_str(str)) == std::string(n, 'b');
+    stra_delete(&str);
+    BENCH_CHECK(ok, "stra_replace_str");
+    return BENCH_NS;
+}
+
+static double stra_remove_range_bench(size_t n)
+{
+    std::string src(n, 'a');
+    string_a* str = stra_from_str(src.c_str());
+    size_t failed = 0;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i)
+        failed += CTL_FAILED(stra_remove_range(str, stra_length(str) / 2, 1));
+    BENCH_END
+
+    bool ok = !failed && stra_length(str) == 0;
+    stra_delete(&str);
+    BENCH_CHECK(ok, "stra_remove_range");
+    return BENCH_NS;
+}
+
+static double stra_substr_bench(size_t n)
+{
+    std::string src(n, 'a');
+    string_a* str = stra_from_str(src.c_str());
+    size_t total = 0;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i) {
+        string_a* sub = stra_substr(str, i % (n - 8), 8);
+        if (sub) {
+            total += stra_length(sub);
+            stra_delete(&sub);
+        }
+    }
+    BENCH_END
+
+    sink = total;
+    stra_delete(&str);
+    BENCH_CHECK(total == n * 8, "stra_substr");
+    return BENCH_NS;
+}
+
+static double stra_compare_str_bench(size_t n)
+{
+    std::string src(n, 'a');
+    string_a* str = stra_from_str(src.c_str());
+    int result = -1;
+
+    BENCH_REPEAT_BEGIN
+    result = stra_compare_str(str, src.c_str());     /* equal strings: full scan */
+    BENCH_REPEAT_END
+
+    sink = (uint64_t)result;
+    stra_delete(&str);
+    BENCH_CHECK(result == 0, "stra_compare_str");
+    return BENCH_NS;
+}
+
+static double stra_find_last_chr_bench(size_t n)
+{
+    std::string src(n, 'a');
+    src[0] = 'b'; /* hit at the front: full scan (stra_find_last_chr of CTSL 1.0 faults on a miss) */
+    string_a* str = stra_from_str(src.c_str());
+    size_t pos = 1;
+
+    BENCH_REPEAT_BEGIN
+    pos = stra_find_last_chr(str, 'b');
+    BENCH_REPEAT_END
+
+    sink = pos;
+    stra_delete(&str);
+    BENCH_CHECK(pos == 0, "stra_find_last_chr");
+    return BENCH_NS;
+}
+
+static double stra_reverse_bench(size_t n)
+{
+    std::string src(n, 'a');
+    src[0] = 'b';
+    string_a* str = stra_from_str(src.c_str());
+    size_t failed = 0;
+
+    BENCH_REPEAT_BEGIN
+    failed += CTL_FAILED(stra_reverse(str));
+    BENCH_REPEAT_END
+
+    size_t b_pos = bench_calls % 2 ? n - 1 : 0;    /* an even number of reversals restores the string */
+    bool ok = !failed && stra_length(str) == n && stra_c_str(str)[b_pos] == 'b';
+    stra_delete(&str);
+    BENCH_CHECK(ok, "stra_reverse");
+    return BENCH_NS;
+}
+
+static double strw_from_str_bench(size_t n)
+{
+    std::wstring src(n, L'a');
+    std::vector<string_w*> strs(bench_repeat);
+
+    BENCH_REPEAT_BEGIN
+    strs[BENCH_K] = strw_from_str(src.c_str());
+    BENCH_REPEAT_END
+
+    bool ok = true;
+    for (string_w* str : strs) {
+        ok = ok && str && strw_length(str) == n;
+        if (str)
+            strw_delete(&str);
+    }
+    BENCH_CHECK(ok, "strw_from_str");
+    return BENCH_NS;
+}
+
+static double strw_find_str_bench(size_t n)
+{
+    std::wstring src(n, L'a');
+    src[n - 1] = L'b';
+    string_w* str = strw_from_str(src.c_str());
+
+    size_t pos = 0;
+
+    BENCH_REPEAT_BEGIN
+    pos = strw_find_str(str, L"aab", 0);
+    BENCH_REPEAT_END
+
+    sink = pos;
+    strw_delete(&str);
+    BENCH_CHECK(pos == n - 3, "strw_find_str");
+    return BENCH_NS;
+}
+
+static double strw_reverse_bench(size_t n)
+{
+    std::wstring src(n, L'a');
+    src[0] = L'b';
+    string_w* str = strw_from_str(src.c_str());
+
+    size_t failed = 0;
+
+    BENCH_REPEAT_BEGIN
+    failed += CTL_FAILED(strw_reverse(str));
+    BENCH_REPEAT_END
+
+    size_t b_pos = bench_calls % 2 ? n - 1 : 0;    /* an even number of reversals restores the string */
+    bool ok = !failed && strw_length(str) == n && strw_c_str(str)[b_pos] == L'b';
+    strw_delete(&str);
+    BENCH_CHECK(ok, "strw_reverse");
+    return BENCH_NS;
+}
+
+static double stl_string_append_chr_bench(size_t n)
+{
+    std::string str;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i)
+        str.push_back('a');
+    BENCH_END
+
+    sink = str.size();
+    BENCH_CHECK(str.size() == n, "std::string::push_back");
+    return BENCH_NS;
+}
+
+static double stl_string_append_str_bench(size_t n)
+{
+    std::string str;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i)
+        str.append(word);
+    BENCH_END
+
+    sink = str.size();
+    BENCH_CHECK(str.size() == n * strlen(word), "std::string::append");
+    return BENCH_NS;
+}
+
+static double stl_string_find_chr_bench(size_t n)
+{
+    std::string str(n, 'a');
+    str[n - 1] = 'b';
+    size_t pos = 0;
+
+    BENCH_REPEAT_BEGIN
+    bench_escape(&str);
+    pos = str.find('b');
+    BENCH_REPEAT_END
+
+    sink = pos;
+    BENCH_CHECK(pos == n - 1, "std::string::find(char)");
+    return BENCH_NS;
+}
+
+static double stl_string_find_str_bench(size_t n)
+{
+    std::string str(n, 'a');
+    str[n - 1] = 'b';
+    size_t pos = 0;
+
+    BENCH_REPEAT_BEGIN
+    bench_escape(&str);
+    pos = str.find("aab");
+    BENCH_REPEAT_END
+
+    sink = pos;
+    BENCH_CHECK(pos == n - 3, "std::string::find");
+    return BENCH_NS;
+}
+
+static double stl_string_insert_front_bench(size_t n)
+{
+    std::string str(1, 'a');
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i)
+        str.insert(str.begin(), 'a');
+    BENCH_END
+
+    sink = str.size();
+    BENCH_CHECK(str.size() == n + 1, "std::string::insert");
+    return BENCH_NS;
+}
+
+static double stl_to_string_stoi_bench(size_t n)
+{
+    uint64_t sum = 0;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i)
+        sum += std::stoi(std::to_string(keys[i]));
+    BENCH_END
+
+    sink = sum;
+    BENCH_CHECK(sum == keys_sum(n), "std::to_string/std::stoi");
+    return BENCH_NS;
+}
+
+static double stl_to_string_stod_bench(size_t n)
+{
+    double sum = 0;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i)
+        sum += std::stod(std::to_string(keys[i] * 0.25));
+    BENCH_END
+
+    sink = (uint64_t)sum;
+    BENCH_CHECK(sum == (double)keys_sum(n) * 0.25, "std::to_string/std::stod");
+    return BENCH_NS;
+}
+
+static double stl_string_split_bench(size_t n)
+{
+    std::string str;
+    for (size_t i = 0; i < n; ++i)
+        str.append(word);
+    std::vector<std::vector<std::string>> splits(bench_repeat);
+
+    BENCH_REPEAT_BEGIN
+    std::vector<std::string>& tokens = splits[BENCH_K];
+    size_t pos = 0, next;
+    while ((next = str.find(',', pos)) != std::string::npos) {
+        tokens.emplace_back(str, pos, next - pos);
+        pos = next + 1;
+    }
+    tokens.emplace_back(str, pos);
+    BENCH_REPEAT_END
+
+    bool ok = true;
+    for (const std::vector<std::string>& tokens : splits)
+        ok = ok && tokens.size() == n + 1;
+
+    sink = splits.size();
+    BENCH_CHECK(ok, "std::string split");
+    return BENCH_NS;
+}
+
+static double stl_string_replace_bench(size_t n)
+{
+    std::string str(n, 'a');
+    const std::string replacement("b");
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i)
+        str.replace(i, 1, replacement);
+    BENCH_END
+
+    sink = str.size();
+    BENCH_CHECK(str == std::string(n, 'b'), "std::string::replace");
+    return BENCH_NS;
+}
+
+static double stl_string_erase_bench(size_t n)
+{
+    std::string str(n, 'a');
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i)
+        str.erase(str.size() / 2, 1);
+    BENCH_END
+
+    sink = str.size();
+    BENCH_CHECK(str.empty(), "std::string::erase");
+    return BENCH_NS;
+}
+
+static double stl_string_substr_bench(size_t n)
+{
+    std::string str(n, 'a');
+    size_t total = 0;
+
+    BENCH_BEGIN
+    for (size_t i = 0; i < n; ++i)
+        total += str.substr(i % (n - 8), 8).size();
+    BENCH_END
+
+    sink = total;
+    BENCH_CHECK(total == n * 8, "std::string::substr");
+    return BENCH_NS;
+}
+
+static double stl_string_compare_bench(size_t n)
+{
+    std::string str(n, 'a');
+    std::string other(str);
+    int result = -1;
+
+    BENCH_REPEAT_BEGIN
+    bench_escape(&str);
+    result = str.compare(other.c_str());
+    BENCH_REPEAT_END
+
+    sink = (uint64_t)result;
+    BENCH_CHECK(result == 0, "std::string::compare");
+    return BENCH_NS;
+}
+
+static double stl_string_rfind_chr_bench(size_t n)
+{
+    std::string str(n, 'a');
+    str[0] = 'b';
+    size_t pos = 1;
+
+    BENCH_REPEAT_BEGIN
+    bench_escape(&str);
+    pos = str.rfind('b');
+    BENCH_REPEAT_END
+
+    sink = pos;
+    BENCH_CHECK(pos == 0, "std::string::rfind(char)");
+    return BENCH_NS;
+}
+
+static double stl_string_reverse_bench(size_t n)
+{
+    std::string str(n, 'a');
+    str[0] = 'b';
+
+    BENCH_REPEAT_BEGIN
+    bench_escape(&str);
+    std::reverse(str.begin(), str.end());
+    BENCH_REPEAT_END
+
+    sink = str.size();
+    BENCH_CHECK(str[bench_calls % 2 ? n - 1 : 0] == 'b', "std::reverse");
+    return BENCH_NS;
+}
+
+static double stl_wstring_copy_bench(size_t n)
+{
+    std::wstring src(n, L'a');
+    std::vector<std::wstring> strs(bench_repeat);
+
+    BENCH_REPEAT_BEGIN
+    strs[BENCH_K] = src;
+    BENCH_REPEAT_END
+
+    bool ok = true;
+    for (const std::wstring& str : strs)
+        ok = ok && str.size() == n;
+
+    sink = strs.size();
+    BENCH_CHECK(ok, "std::wstring copy");
+    return BENCH_NS;
+}
+
+static double stl_wstring_find_str_bench(size_t n)
+{
+    std::wstring str(n, L'a');
+    str[n - 1] = L'b';
+    size_t pos = 0;
+
+    BENCH_REPEAT_BEGIN
+    bench_escape(&str);
+    pos = str.find(L"aab");
+    BENCH_REPEAT_END
+
+    sink = pos;
+    BENCH_CHECK(pos == n - 3, "std::wstring::find");
+    return BENCH_NS;
+}
+
+static double stl_wstring_reverse_bench(size_t n)
+{
+    std::wstring str(n, L'a');
+    str[0] = L'b';
+
+    BENCH_REPEAT_BEGIN
+    bench_escape(&str);
+    std::reverse(str.begin(), str.end());
+    BENCH_REPEAT_END
+
+    sink = str.size();
+    BENCH_CHECK(str[bench_calls % 2 ? n - 1 : 0] == L'b', "std::reverse");
+    return BENCH_NS;
+}
+
+#pragma endregion
+
+#pragma region cases
+
+#define ALL_SIZES   (size_t)-1
+#define LARGE       (size_t)1e7 /* one object_t or node per item: larger sizes need several GB */
+#define QUADRATIC   (size_t)1e5 /* O(n^2) in total (stra_append_str of CTSL 1.0 included) */
+#define LIST_SCAN   (size_t)1e4 /* O(n^2) node walks: the cache misses make 1e5 take minutes per run */
+
+static const bench_case_t cases[] = {
+    {"vector_st",   "push_back",        "ctsl", ALL_SIZES,  vect_push_back_bench},
+    {"vector_st",   "push_back",        "stl",  ALL_SIZES,  stl_vector_push_back_bench},
+    {"vector_st",   "item_direct",      "ctsl", ALL_SIZES,  vect_item_direct_bench},
+    {"vector_st",   "item",             "ctsl", ALL_SIZES,  vect_item_bench},
+    {"vector_st",   "item_direct",      "stl",  ALL_SIZES,  stl_vector_index_bench},
+    {"vector_st",   "find_item",        "ctsl", ALL_SIZES,  vect_find_item_bench},
+    {"vector_st",   "find_item",        "stl",  ALL_SIZES,  stl_vector_find_bench},
+    {"vector_st",   "sort",             "ctsl", ALL_SIZES,  vect_sort_bench},
+    {"vector_st",   "sort",             "stl",  ALL_SIZES,  stl_vector_sort_bench},
+    {"vector_st",   "clone",            "ctsl", ALL_SIZES,  vect_clone_bench},
+    {"vector_st",   "clone",            "stl",  ALL_SIZES,  stl_vector_copy_bench},
+    {"vector_st",   "remove_front",     "ctsl", QUADRATIC,  vect_remove_front_bench},
+    {"vector_st",   "remove_front",     "stl",  QUADRATIC,  stl_vector_erase_front_bench},
+    {"vector_st",   "insert_middle",    "ctsl", QUADRATIC,  vect_insert_middle_bench},
+    {"vector_st",   "insert_middle",    "stl",  QUADRATIC,  stl_vector_insert_middle_bench},
+    {"vector_st",   "remove_range",     "ctsl", QUADRATIC,  vect_remove_range_bench},
+    {"vector_st",   "remove_range",     "stl",  QUADRATIC,  stl_vector_erase_range_bench},
+
+    {"vector_gn",   "push_back",        "ctsl", LARGE,      vecg_push_back_bench},
+    {"vector_gn",   "push_back",        "stl",  LARGE,      stl_any_push_back_bench},
+    {"vector_gn",   "item",             "ctsl", LARGE,      vecg_item_bench},
+    {"vector_gn",   "item",             "stl",  LARGE,      stl_any_item_bench},
+    {"vector_gn",   "find_item",        "ctsl", LARGE,      vecg_find_item_bench},
+    {"vector_gn",   "find_item",        "stl",  LARGE,      stl_any_find_bench},
+    {"vector_gn",   "sort",             "ctsl", LARGE,      vecg_sort_bench},
+    {"vector_gn",   "sort",             "stl",  LARGE,      stl_any_sort_bench},
+
+    {"map",         "insert",           "ctsl", LARGE,      map_insert_bench},
+    {"map",         "insert",           "stl",  LARGE,      stl_map_insert_bench},
+    {"map",         "value_by_key",     "ctsl", LARGE,      map_value_by_key_bench},
+    {"map",         "value_by_key",     "stl",  LARGE,      stl_map_find_bench},
+    {"map",         "contains_value",   "ctsl", LARGE,      map_contains_value_bench},
+    {"map",         "contains_value",   "stl",  LARGE,      stl_map_find_value_bench},
+    {"map",         "iterate",          "ctsl", LARGE,      map_iterate_bench},
+    {"map",         "iterate",          "stl",  LARGE,      stl_map_iterate_bench},
+    {"map",         "key_remove",       "ctsl", LARGE,      map_key_remove_bench},
+    {"map",         "key_remove",       "stl",  LARGE,      stl_map_erase_bench},
+
+    {"slist",       "push_back",        "ctsl", LARGE,      slist_push_back_bench},
+    {"slist",       "push_back",        "stl",  LARGE,      stl_list_push_back_bench},
+    {"slist",       "push_head",        "ctsl", LARGE,      slist_push_head_bench},
+    {"slist",       "push_head",        "stl",  LARGE,      stl_list_push_front_bench},
+    {"slist",       "contains_item",    "ctsl", LARGE,      slist_contains_item_bench},
+    {"slist",       "contains_item",    "stl",  LARGE,      stl_list_find_bench},
+    {"slist",       "remove_head",      "ctsl", LARGE,      slist_remove_head_bench},
+    {"slist",       "remove_head",      "stl",  LARGE,      stl_list_pop_front_bench},
+    {"slist",       "remove_item",      "ctsl", LIST_SCAN,  slist_remove_item_bench},
+    {"slist",       "remove_item",      "stl",  LIST_SCAN,  stl_list_remove_bench},
+
+    {"queue_st",    "push",             "ctsl", ALL_SIZES,  qus_push_bench},
+    {"queue_st",    "push",             "stl",  ALL_SIZES,  stl_queue_push_bench},
+    {"queue_st",    "pop",              "ctsl", ALL_SIZES,  qus_pop_bench},
+    {"queue_st",    "pop",              "stl",  ALL_SIZES,  stl_queue_pop_bench},
+    {"queue_gn",    "push",             "ctsl", LARGE,      qug_push_bench},
+    {"queue_gn",    "push",             "stl",  LARGE,      stl_any_queue_push_bench},
+    {"queue_gn",    "pop",              "ctsl", LARGE,      qug_pop_bench},
+    {"queue_gn",    "pop",              "stl",  LARGE,      stl_any_queue_pop_bench},
+
+    {"string_a",    "append_chr",       "ctsl", ALL_SIZES,  stra_append_chr_bench},
+    {"string_a",    "append_chr",       "stl",  ALL_SIZES,  stl_string_append_chr_bench},
+    {"string_a",    "append_str",       "ctsl", QUADRATIC,  stra_append_str_bench},
+    {"string_a",    "append_str",       "stl",  QUADRATIC,  stl_string_append_str_bench},
+    {"string_a",    "find_chr",         "ctsl", ALL_SIZES,  stra_find_chr_bench},
+    {"string_a",    "find_chr",         "stl",  ALL_SIZES,  stl_string_find_chr_bench},
+    {"string_a",    "find_str",         "ctsl", ALL_SIZES,  stra_find_str_bench},
+    {"string_a",    "find_str",         "stl",  ALL_SIZES,  stl_string_find_str_bench},
+    {"string_a",    "insert_front",     "ctsl", QUADRATIC,  stra_insert_front_bench},
+    {"string_a",    "insert_front",     "stl",  QUADRATIC,  stl_string_insert_front_bench},
+    {"string_a",    "itos_stoi",        "ctsl", LARGE,      stra_itos_stoi_bench},
+    {"string_a",    "itos_stoi",        "stl",  LARGE,      stl_to_string_stoi_bench},
+    {"string_a",    "dtos_stod",        "ctsl", LARGE,      stra_dtos_stod_bench},
+    {"string_a",    "dtos_stod",        "stl",  LARGE,      stl_to_string_stod_bench},
+    {"string_a",    "splitter",         "ctsl", LARGE,      stra_splitter_bench},
+    {"string_a",    "splitter",         "stl",  LARGE,      stl_string_split_bench},
+    {"string_a",    "replace_str",      "ctsl", ALL_SIZES,  stra_replace_str_bench},
+    {"string_a",    "replace_str",      "stl",  ALL_SIZES,  stl_string_replace_bench},
+    {"string_a",    "remove_range",     "ctsl", QUADRATIC,  stra_remove_range_bench},
+    {"string_a",    "remove_range",     "stl",  QUADRATIC,  stl_string_erase_bench},
+    {"string_a",    "substr",           "ctsl", LARGE,      stra_substr_bench},
+    {"string_a",    "substr",           "stl",  LARGE,      stl_string_substr_bench},
+    {"string_a",    "compare_str",      "ctsl", ALL_SIZES,  stra_compare_str_bench},
+    {"string_a",    "compare_str",      "stl",  ALL_SIZES,  stl_string_compare_bench},
+    {"string_a",    "find_last_chr",    "ctsl", ALL_SIZES,  stra_find_last_chr_bench},
+    {"string_a",    "find_last_chr",    "stl",  ALL_SIZES,  stl_string_rfind_chr_bench},
+    {"string_a",    "reverse",          "ctsl", ALL_SIZES,  stra_reverse_bench},
+    {"string_a",    "reverse",          "stl",  ALL_SIZES,  stl_string_reverse_bench},
+
+    {"string_w",    "from_str",         "ctsl", ALL_SIZES,  strw_from_str_bench},
+    {"string_w",    "from_str",         "stl",  ALL_SIZES,  stl_wstring_copy_bench},
+    {"string_w",    "find_str",         "ctsl", ALL_SIZES,  strw_find_str_bench},
+    {"string_w",    "find_str",         "stl",  ALL_SIZES,  stl_wstring_find_str_bench},
+    {"string_w",    "reverse",          "ctsl", ALL_SIZES,  strw_reverse_bench},
+    {"string_w",    "reverse",          "stl",  ALL_SIZES,  stl_wstring_reverse_bench},
+};
+
+#pragma endregion
+
+
+#pragma region runner
+
+#define P99_MIN_SAMPLES     100
+#define MIN_REGION_NS       10000.0 /* shortest timed region of the single-call cases: 10 us */
+
+static double clock_overhead_ns() //median of an empty timed region
+{
+    std::vector<double> samples(1001);
+
+    for (double& s : samples) {
+        BENCH_BEGIN
+        BENCH_END
+        s = BENCH_NS;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+static double percentile(const std::vector<double>& sorted, double p) //nearest-rank
+{
+    size_t rank = (size_t)std::ceil(p / 100.0 * (double)sorted.size());
+    return sorted[rank ? rank - 1 : 0];
+}
+
+//returns false (with bench_error set) as soon as one run of the case fails: no timing is reported for it
+static bool run_case(const bench_case_t* bcase, size_t n, const bench_config_t* cfg, bench_result_t* result)
+{
+    bench_result_t res = {};
+    std::vector<double> samples;
+    double total_ns = 0;
+
+    bench_error = NULL;
+    bench_repeat = 1;
+
+    for (size_t i = 0; i < cfg->warmup + 3; ++i) {  /* warm-up runs, plus up to 3 runs calibrating bench_repeat */
+        double ns = bcase->run(n);
+        if (bench_error)
+            return false;
+
+        if (ns * (double)bench_calls < MIN_REGION_NS)  /* the per-call time gets more accurate as the region grows */
+            bench_repeat = (size_t)std::ceil(MIN_REGION_NS / std::max(ns, 1.0));
+        else if (i >= cfg->warmup)    /* a cold warm-up run must not end the calibration */
+            break;
+    }
+
+    while (samples.size() < cfg->reps || (total_ns < cfg->min_time * 1e9 && samples.size() < cfg->max_reps)) {
+        double ns = bcase->run(n);
+        if (bench_error)
+            return false;
+
+        samples.push_back(ns);
+        total_ns += ns;
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    double sq = 0;
+    res.mean_ns = total_ns / (double)samples.size();
+    for (double s : samples)
+        sq += (s - res.mean_ns) * (s - res.mean_ns);
+
+    res.bcase = bcase;
+    res.size = n;
+    res.reps = samples.size();
+    res.calls = bench_calls;
+    res.median_ns = percentile(samples, 50);
+    res.p99_ns = samples.size() >= P99_MIN_SAMPLES ? percentile(samples, 99) : NAN;
+    res.min_ns = samples.front();
+    res.stddev_ns = std::sqrt(sq / (double)samples.size());
+    res.ops_per_sec = res.median_ns > 0 ? (double)n * 1e9 / res.median_ns : 0;
+    *result = res;
+    return true;
+}
+
+static const char* json_number(double value, char* buf, size_t size) //NAN is written as null
+{
+    if (std::isnan(value))
+        return "null";
+
+    snprintf(buf, size, "%.0f", value);
+    return buf;
+}
+
+static bool write_json(const char* path, const bench_config_t* cfg, double overhead_ns, const std::vector<bench_result_t>& results,
+                       const std::vector<bench_failure_t>& failures)
+{
+    FILE* f = fopen(path, "w");
+    if (!f)
+        return false;
+
+    fprintf(f, "{\n  \"library\": \"ctsl\",\n  \"label\": \"%s\",\n  \"timestamp\": %lld,\n", cfg->label, (long long)time(NULL));
+    fprintf(f, "  \"config\": {\"min_size\": %zu, \"max_size\": %zu, \"reps\": %zu, \"warmup\": %zu, \"max_reps\": %zu, \"min_time_sec\": %g, "
+               "\"min_region_ns\": %.0f, \"clock_overhead_ns\": %.0f, \"build_type\": \"%s\", \"compiler\": \"%s\", \"optimized\": %s},\n",
+            cfg->min_size, cfg->max_size, cfg->reps, cfg->warmup, cfg->max_reps, cfg->min_time, MIN_REGION_NS, overhead_ns,
+            *CTSL_BENCH_BUILD_TYPE ? CTSL_BENCH_BUILD_TYPE : "none", CTSL_BENCH_COMPILER, CTSL_BENCH_OPTIMIZED ? "true" : "false");
+    fprintf(f, "  \"results\": [\n");
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const bench_result_t* r = &results[i];
+        char p99[32];
+        fprintf(f, "    {\"group\": \"%s\", \"op\": \"%s\", \"impl\": \"%s\", \"size\": %zu, \"reps\": %zu, \"calls\": %zu, "
+                   "\"median_ns\": %.0f, \"p99_ns\": %s, \"min_ns\": %.0f, \"mean_ns\": %.0f, \"stddev_ns\": %.0f, \"ops_per_sec\": %.0f}%s\n",
+                r->bcase->group, r->bcase->op, r->bcase->impl, r->size, r->reps, r->calls,
+                r->median_ns, json_number(r->p99_ns, p99, sizeof(p99)), r->min_ns, r->mean_ns, r->stddev_ns, r->ops_per_sec,
+                i + 1 < results.size() ? "," : "");
+    }
+
+    fprintf(f, "  ],\n  \"failures\": [\n");
+
+    for (size_t i = 0; i < failures.size(); ++i) {
+        const bench_failure_t* e = &failures[i];
+        fprintf(f, "    {\"group\": \"%s\", \"op\": \"%s\", \"impl\": \"%s\", \"size\": %zu, \"error\": \"%s\"}%s\n",
+                e->bcase->group, e->bcase->op, e->bcase->impl, e->size, e->error,
+                i + 1 < failures.size() ? "," : "");
+    }
+
+    fprintf(f, "  ]\n}\n");
+    fclose(f);
+    return true;
+}
+
+static bool parse_args(int argc, char** argv, bench_config_t* cfg)
+{
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 >= argc) {
+            fprintf(stderr, "Missing value for '%s'.\n", argv[i]);
+            return false;
+        }
+
+        const char* arg = argv[i];
+        const char* val = argv[++i];
+
+        if (!strcmp(arg, "--min"))
+            cfg->min_size = (size_t)atof(val);
+        else if (!strcmp(arg, "--max"))
+            cfg->max_size = (size_t)atof(val);
+        else if (!strcmp(arg, "--reps"))
+            cfg->reps = (size_t)atof(val);
+        else if (!strcmp(arg, "--warmup"))
+            cfg->warmup = (size_t)atof(val);
+        else if (!strcmp(arg, "--max-reps"))
+            cfg->max_reps = (size_t)atof(val);
+        else if (!strcmp(arg, "--min-time"))
+            cfg->min_time = atof(val);
+        else if (!strcmp(arg, "--filter"))
+            cfg->filter = val;
+        else if (!strcmp(arg, "--json"))
+            cfg->json_path = val;
+        else if (!strcmp(arg, "--label"))
+            cfg->label = val;
+        else {
+            fprintf(stderr, "Unknown option '%s'.\n", arg);
+            return false;
+        }
+    }
+
+    if (strpbrk(cfg->label, "\"\\")) {
+        fprintf(stderr, "The label must not contain quotes or backslashes.\n");
+        return false;
+    }
+
+    if (cfg->min_size == 0 || cfg->max_size < cfg->min_size || cfg->reps == 0) {
+        fprintf(stderr, "Invalid size range or repetition count.\n");
+        return false;
+    }
+
+    return true;
+}
+
+#pragma endregion
+
+
+int main(int argc, char** argv){
+    bench_config_t cfg = { (size_t)1e2, (size_t)1e8, 5, 1, 10000, 0.2, NULL, "ctsl_bench.json", CTSL_BENCH_LABEL };
+
+    if (!parse_args(argc, argv, &cfg)) {
+        fprintf(stderr, "usage: %s [--min 1e2] [--max 1e8] [--reps 5] [--warmup 1] [--max-reps 10000] [--min-time 0.2] [--filter text] [--label name] [--json file]\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<bench_result_t> results;
+    std::vector<bench_failure_t> failures;
+    bench_result_t res;
+    char name[128];
+    double overhead_ns = clock_overhead_ns();
+
+    if (!*cfg.label)
+        fprintf(stderr, "No --label given: the results cannot be told apart from other releases.\n");
+
+    printf("%-36s %5s %12s %6s %14s %14s %14s\n", "benchmark", "impl", "size", "reps", "median (ns)", "p99 (ns)", "ops/sec");
+
+    for (size_t n = cfg.min_size; n <= cfg.max_size; n *= 10) {
+        prepare_keys(n);
+
+        for (const bench_case_t& bcase : cases) {
+            snprintf(name, sizeof(name), "%s/%s", bcase.group, bcase.op);
+            if (n > bcase.max_size || (cfg.filter && !strstr(name, cfg.filter)))
+                continue;
+
+            if (!run_case(&bcase, n, &cfg, &res)) {
+                failures.push_back({ &bcase, n, bench_error });
+                printf("%-36s %5s %12zu FAILED: %s\n", name, bcase.impl, n, bench_error);
+                fflush(stdout);
+                continue;
+            }
+
+            results.push_back(res);
+
+            if (std::isnan(res.p99_ns))
+                printf("%-36s %5s %12zu %6zu %14.0f %14s %14.4g\n", name, bcase.impl, n, res.reps, res.median_ns, "-", res.ops_per_sec);
+            else
+                printf("%-36s %5s %12zu %6zu %14.0f %14.0f %14.4g\n", name, bcase.impl, n, res.reps, res.median_ns, res.p99_ns, res.ops_per_sec);
+            fflush(stdout);
+        }
+
+        if (n > cfg.max_size / 10)
+            break;
+    }
+
+    if (!write_json(cfg.json_path, &cfg, overhead_ns, results, failures)) {
+        fprintf(stderr, "Failed to write '%s'.\n", cfg.json_path);
+        return 1;
+    }
+
+    printf("\nResults written to '%s'.\n", cfg.json_path);
+
+    if (!failures.empty()) {
+        fprintf(stderr, "%zu case(s) failed and were not timed.\n", failures.size());
+        return 1;
+    }
+
+    return 0;
+}